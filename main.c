@@ -4,6 +4,7 @@
 #include <math.h>
 #include "raylib.h"
 #include "raymath.h"
+#include "stats.h"
 
 #define MAX_SOUNDS 3
 typedef enum {
@@ -35,6 +36,8 @@ Texture2D textures[MAX_TEXTURES];
 #define CELL_PADDING_PERCENT 0.03f
 #define STATUS_BAR_HEIGHT_PERCENT 0.08f
 
+#define STATS_FILE "minesweeper_stats.bin"
+
 typedef enum {
     MENU,
     PLAYING,
@@ -66,6 +69,14 @@ bool playerWon = false;
 GameState currentState = MENU;
 bool isFirstClick = true;
 
+int currentLevel = 0;
+unsigned int gameSeed = 0;
+int firstClickX = 0;
+int firstClickY = 0;
+int clickCount = 0;
+int board3BV = 0;
+double gameStartTime = 0.0;
+
 bool isSoundEnabled = true;
 bool isMusicEnabled = true;
 
@@ -74,6 +85,7 @@ DifficultyLevel gameLevels[] = {
     {"Intermediate", 16, 16, 40},
     {"Expert", 30, 16, 99},
 };
+#define LEVEL_COUNT (int)(sizeof(gameLevels) / sizeof(gameLevels[0]))
 
 float cellSize;
 float cellPadding;
@@ -88,6 +100,8 @@ bool IsValidCell(int x, int y);
 void CheckForWin(void);
 void RevealCell(int x, int y);
 void PlaceMines(int safeX, int safeY);
+int Calculate3BV(void);
+void RecordFinishedGame(GameResult result);
 void DrawMainMenu(void);
 void DrawGameBoard(void);
 void HandlePlayerInput(void);
@@ -222,6 +236,7 @@ void CheckForWin(void) {
     currentState = WON;
     gameIsOver = true;
     GamePlaySound(SOUND_FLAG);
+    RecordFinishedGame(GAME_RESULT_WON);
 }
 
 void RevealCell(int x, int y) {
@@ -241,6 +256,7 @@ void RevealCell(int x, int y) {
                 if (gameBoard[r][c].hasMine) gameBoard[r][c].isRevealed = true;
             }
         }
+        RecordFinishedGame(GAME_RESULT_LOST);
         return;
     }
     else {
@@ -265,6 +281,15 @@ void PlaceMines(int safeX, int safeY) {
         }
     }
 
+    firstClickX = safeX;
+    firstClickY = safeY;
+    // GetRandomValue may be backed by rand(), so draw 15 bits at a time to stay
+    // within the smallest RAND_MAX the C standard allows.
+    gameSeed = ((unsigned int)GetRandomValue(0, 0x7FFF) << 30) ^
+        ((unsigned int)GetRandomValue(0, 0x7FFF) << 15) ^
+        (unsigned int)GetRandomValue(0, 0x7FFF);
+    SetRandomSeed(gameSeed);
+
     bool safeZone[MAX_BOARD_HEIGHT][MAX_BOARD_WIDTH] = { false };
 
     for (int dy = -1; dy <= 1; dy++) {
@@ -305,6 +330,74 @@ void PlaceMines(int safeX, int safeY) {
             gameBoard[y][x].neighborMines = surroundingMineCount;
         }
     }
+
+    board3BV = Calculate3BV();
+}
+
+int Calculate3BV(void) {
+    bool counted[MAX_BOARD_HEIGHT][MAX_BOARD_WIDTH] = { false };
+    int stackX[MAX_BOARD_WIDTH * MAX_BOARD_HEIGHT];
+    int stackY[MAX_BOARD_WIDTH * MAX_BOARD_HEIGHT];
+    int bbbv = 0;
+
+    // Each opening (connected region of zeros plus its numbered border) is one click.
+    for (int y = 0; y < currentHeight; y++) {
+        for (int x = 0; x < currentWidth; x++) {
+            if (counted[y][x] || gameBoard[y][x].hasMine || gameBoard[y][x].neighborMines != 0) continue;
+
+            bbbv++;
+            int top = 0;
+            counted[y][x] = true;
+            stackX[top] = x;
+            stackY[top] = y;
+            top++;
+
+            while (top > 0) {
+                top--;
+                int cx = stackX[top];
+                int cy = stackY[top];
+                for (int dy = -1; dy <= 1; dy++) {
+                    for (int dx = -1; dx <= 1; dx++) {
+                        int nx = cx + dx;
+                        int ny = cy + dy;
+                        if (!IsValidCell(nx, ny) || counted[ny][nx] || gameBoard[ny][nx].hasMine) continue;
+
+                        counted[ny][nx] = true;
+                        if (gameBoard[ny][nx].neighborMines == 0) {
+                            stackX[top] = nx;
+                            stackY[top] = ny;
+                            top++;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // Every numbered cell not uncovered by an opening needs its own click.
+    for (int y = 0; y < currentHeight; y++) {
+        for (int x = 0; x < currentWidth; x++) {
+            if (!counted[y][x] && !gameBoard[y][x].hasMine) bbbv++;
+        }
+    }
+    return bbbv;
+}
+
+void RecordFinishedGame(GameResult result) {
+    GameRecord record = { 0 };
+    record.seed = gameSeed;
+    record.timeMs = (uint32_t)((GetTime() - gameStartTime) * 1000.0);
+    record.clicks = (uint32_t)clickCount;
+    record.bbbv = (uint16_t)board3BV;
+    record.level = (uint8_t)currentLevel;
+    record.result = (uint8_t)result;
+    record.finishedAt = (int64_t)time(NULL);
+    record.firstX = (uint8_t)firstClickX;
+    record.firstY = (uint8_t)firstClickY;
+
+    if (!StatsAppend(record)) {
+        TraceLog(LOG_WARNING, "STATS: Failed to record finished game.");
+    }
 }
 
 void DrawMainMenu(void) {
@@ -329,10 +422,30 @@ void DrawMainMenu(void) {
     int btnTextSize = (int)(btnHeight * 0.4f);
     btnTextSize = fmaxf(btnTextSize, 16);
 
-    for (int i = 0; i < 3; i++) {
+    int statsTextSize = (int)(btnSpacing * 0.6f);
+    statsTextSize = fmaxf(statsTextSize, 10);
+
+    for (int i = 0; i < LEVEL_COUNT; i++) {
         float btnY = screenH * 0.4f + i * (btnHeight + btnSpacing);
+
+        const LevelStats* stats = StatsGetLevel(i);
+        if (stats != NULL && stats->played > 0) {
+            char statsText[96];
+            if (stats->bestTimeCount > 0) {
+                snprintf(statsText, sizeof(statsText), "Best: %.2fs   Wins: %u/%u (%u%%)   Streak: %u (best %u)",
+                    stats->bestTimesMs[0] / 1000.0f, stats->won, stats->played, (unsigned int)((uint64_t)stats->won * 100 / stats->played),
+                    stats->currentStreak, stats->bestStreak);
+            }
+            else {
+                snprintf(statsText, sizeof(statsText), "Best: --   Wins: 0/%u (0%%)   Streak: 0 (best 0)", stats->played);
+            }
+            DrawText(statsText, screenW / 2 - MeasureText(statsText, statsTextSize) / 2,
+                btnY + btnHeight + (btnSpacing - statsTextSize) / 2, statsTextSize, DARKGRAY);
+        }
+
         if (DrawStyledButton(screenW / 2 - btnWidth / 2, btnY, btnWidth, btnHeight, gameLevels[i].name, btnTextSize, LIGHTGRAY, GRAY, BLACK)) {
             GamePlaySound(SOUND_CLICK);
+            currentLevel = i;
             currentWidth = gameLevels[i].width;
             currentHeight = gameLevels[i].height;
             mineCount = gameLevels[i].mines;
@@ -505,6 +618,8 @@ void ResetGame(void) {
     gameIsOver = false;
     playerWon = false;
     isFirstClick = true;
+    clickCount = 0;
+    board3BV = 0;
 }
 
 int CountSurroundingFlags(int x, int y) {
@@ -552,11 +667,16 @@ void HandlePlayerInput(void) {
 
     Cell* clickedCell = &gameBoard[cellY][cellX];
 
+    if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) || IsMouseButtonPressed(MOUSE_RIGHT_BUTTON)) {
+        clickCount++;
+    }
+
     if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
         if (!clickedCell->isRevealed && !clickedCell->isFlagged) {
             if (isFirstClick) {
                 PlaceMines(cellX, cellY);
                 isFirstClick = false;
+                gameStartTime = GetTime();
             }
             RevealCell(cellX, cellY);
             if (!gameIsOver) CheckForWin();
@@ -614,6 +734,10 @@ int main(void) {
     InitGameAudio();
     LoadGameTextures();
 
+    if (!StatsOpen(STATS_FILE)) {
+        TraceLog(LOG_WARNING, "STATS: Failed to open %s, games will not be recorded.", STATS_FILE);
+    }
+
     int monitorWidth = GetMonitorWidth(GetCurrentMonitor());
     int monitorHeight = GetMonitorHeight(GetCurrentMonitor());
     SetWindowPosition(monitorWidth / 2 - DEFAULT_WIDTH / 2, monitorHeight / 2 - DEFAULT_HEIGHT / 2);
@@ -657,6 +781,7 @@ int main(void) {
         EndDrawing();
     }
 
+    StatsClose();
     UnloadGameTextures();
     ShutdownGameAudio();
     CloseWindow();
@@ -0,0 +1,292 @@
+#include <stddef.h>
+#include <string.h>
+#include "stats.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define STATS_MAGIC "MSSTATS1"
+#define STATS_VERSION 2
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+} StatsHeader;
+
+typedef char GameRecordSizeCheck[(sizeof(GameRecord) == 32) ? 1 : -1];
+typedef char StatsHeaderSizeCheck[(sizeof(StatsHeader) == 16) ? 1 : -1];
+
+typedef struct {
+    const unsigned char* data;
+    uint64_t size;
+} LogView;
+
+static LevelStats levelStats[STATS_MAX_LEVELS];
+static bool statsReady = false;
+
+#if defined(_WIN32)
+static HANDLE logHandle = INVALID_HANDLE_VALUE;
+#else
+static int logHandle = -1;
+#endif
+
+#if defined(_WIN32)
+
+static bool MapLogFile(const char* path, LogView* view) {
+    view->data = NULL;
+    view->size = 0;
+
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return GetLastError() == ERROR_FILE_NOT_FOUND;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        return false;
+    }
+    view->size = (uint64_t)size.QuadPart;
+    if (view->size == 0) {
+        CloseHandle(file);
+        return true;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    if (mapping == NULL) return false;
+
+    view->data = (const unsigned char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    return view->data != NULL;
+}
+
+static void UnmapLogFile(LogView* view) {
+    if (view->data != NULL) UnmapViewOfFile(view->data);
+    view->data = NULL;
+}
+
+static bool TruncateLogFile(const char* path, uint64_t size) {
+    HANDLE file = CreateFileA(path, GENERIC_WRITE, 0, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER offset;
+    offset.QuadPart = (LONGLONG)size;
+    bool ok = SetFilePointerEx(file, offset, NULL, FILE_BEGIN) && SetEndOfFile(file);
+    CloseHandle(file);
+    return ok;
+}
+
+static bool OpenLogForAppend(const char* path) {
+    logHandle = CreateFileA(path, FILE_APPEND_DATA, FILE_SHARE_READ, NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    return logHandle != INVALID_HANDLE_VALUE;
+}
+
+static bool WriteLogDurable(const void* data, uint32_t size) {
+    DWORD written = 0;
+    if (!WriteFile(logHandle, data, size, &written, NULL) || written != size) return false;
+    return FlushFileBuffers(logHandle);
+}
+
+static void CloseLog(void) {
+    if (logHandle != INVALID_HANDLE_VALUE) CloseHandle(logHandle);
+    logHandle = INVALID_HANDLE_VALUE;
+}
+
+#else
+
+static bool MapLogFile(const char* path, LogView* view) {
+    view->data = NULL;
+    view->size = 0;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return access(path, F_OK) != 0;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return false;
+    }
+    view->size = (uint64_t)st.st_size;
+    if (view->size == 0) {
+        close(fd);
+        return true;
+    }
+
+    void* data = mmap(NULL, (size_t)view->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return false;
+
+    view->data = (const unsigned char*)data;
+    return true;
+}
+
+static void UnmapLogFile(LogView* view) {
+    if (view->data != NULL) munmap((void*)view->data, (size_t)view->size);
+    view->data = NULL;
+}
+
+static bool TruncateLogFile(const char* path, uint64_t size) {
+    return truncate(path, (off_t)size) == 0;
+}
+
+static bool OpenLogForAppend(const char* path) {
+    logHandle = open(path, O_WRONLY | O_CREAT | O_APPEND, 0644);
+    return logHandle >= 0;
+}
+
+static bool WriteLogDurable(const void* data, uint32_t size) {
+    const unsigned char* bytes = (const unsigned char*)data;
+    while (size > 0) {
+        ssize_t written = write(logHandle, bytes, size);
+        if (written <= 0) return false;
+        bytes += written;
+        size -= (uint32_t)written;
+    }
+    return fsync(logHandle) == 0;
+}
+
+static void CloseLog(void) {
+    if (logHandle >= 0) close(logHandle);
+    logHandle = -1;
+}
+
+#endif
+
+// FNV-1a over every field before the checksum itself. Enough to reject the
+// torn record a crash mid-write leaves at the end of the log.
+static uint32_t ComputeChecksum(const GameRecord* record) {
+    const unsigned char* bytes = (const unsigned char*)record;
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < offsetof(GameRecord, checksum); i++) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static void IndexRecord(const GameRecord* record) {
+    if (record->level >= STATS_MAX_LEVELS) return;
+
+    LevelStats* stats = &levelStats[record->level];
+    stats->played++;
+
+    if (record->result != GAME_RESULT_WON) {
+        stats->currentStreak = 0;
+        return;
+    }
+
+    stats->won++;
+    stats->currentStreak++;
+    if (stats->currentStreak > stats->bestStreak) stats->bestStreak = stats->currentStreak;
+
+    int slot = stats->bestTimeCount;
+    while (slot > 0 && stats->bestTimesMs[slot - 1] > record->timeMs) slot--;
+    if (slot >= STATS_TOP_TIMES) return;
+
+    int last = stats->bestTimeCount < STATS_TOP_TIMES ? stats->bestTimeCount : STATS_TOP_TIMES - 1;
+    for (int i = last; i > slot; i--) {
+        stats->bestTimesMs[i] = stats->bestTimesMs[i - 1];
+    }
+    stats->bestTimesMs[slot] = record->timeMs;
+    if (stats->bestTimeCount < STATS_TOP_TIMES) stats->bestTimeCount++;
+}
+
+static bool IsValidHeader(const LogView* view) {
+    if (view->size < sizeof(StatsHeader)) return false;
+
+    StatsHeader header;
+    memcpy(&header, view->data, sizeof(header));
+    return memcmp(header.magic, STATS_MAGIC, sizeof(header.magic)) == 0 &&
+        header.version == STATS_VERSION &&
+        header.recordSize == sizeof(GameRecord);
+}
+
+// Walks the mapped log once, folding each intact record into levelStats and
+// skipping any whose checksum does not match. Returns the size the log should
+// be cut to: only a partial record at the end, or a torn final record, is
+// dropped, so corruption in the middle never costs the games after it.
+static uint64_t ReplayLog(const LogView* view) {
+    uint64_t offset = sizeof(StatsHeader);
+    bool lastRecordValid = true;
+    while (offset + sizeof(GameRecord) <= view->size) {
+        GameRecord record;
+        memcpy(&record, view->data + offset, sizeof(record));
+        lastRecordValid = record.checksum == ComputeChecksum(&record);
+        if (lastRecordValid) IndexRecord(&record);
+        offset += sizeof(GameRecord);
+    }
+
+    if (offset != view->size) return offset;
+    if (!lastRecordValid) return offset - sizeof(GameRecord);
+    return offset;
+}
+
+bool StatsOpen(const char* path) {
+    StatsClose();
+    memset(levelStats, 0, sizeof(levelStats));
+
+    LogView view;
+    if (!MapLogFile(path, &view)) return false;
+
+    uint64_t validEnd = 0;
+    if (view.size >= sizeof(StatsHeader)) {
+        if (!IsValidHeader(&view)) {
+            UnmapLogFile(&view);
+            return false;
+        }
+        validEnd = ReplayLog(&view);
+    }
+    uint64_t fileSize = view.size;
+    UnmapLogFile(&view);
+
+    if (validEnd != fileSize && !TruncateLogFile(path, validEnd)) return false;
+    if (!OpenLogForAppend(path)) return false;
+
+    if (validEnd == 0) {
+        StatsHeader header;
+        memcpy(header.magic, STATS_MAGIC, sizeof(header.magic));
+        header.version = STATS_VERSION;
+        header.recordSize = sizeof(GameRecord);
+        if (!WriteLogDurable(&header, sizeof(header))) {
+            CloseLog();
+            return false;
+        }
+    }
+
+    statsReady = true;
+    return true;
+}
+
+void StatsClose(void) {
+    CloseLog();
+    statsReady = false;
+}
+
+bool StatsAppend(GameRecord record) {
+    if (!statsReady) return false;
+
+    record.reserved = 0;
+    record.checksum = ComputeChecksum(&record);
+
+    // A failed write may leave a partial record behind; stop appending so the
+    // next startup can cut it off without losing anything written after it.
+    if (!WriteLogDurable(&record, sizeof(record))) {
+        StatsClose();
+        return false;
+    }
+
+    IndexRecord(&record);
+    return true;
+}
+
+const LevelStats* StatsGetLevel(int level) {
+    if (level < 0 || level >= STATS_MAX_LEVELS) return NULL;
+    return &levelStats[level];
+}
@@ -0,0 +1,47 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define STATS_MAX_LEVELS 8
+#define STATS_TOP_TIMES 3
+
+typedef enum {
+    GAME_RESULT_LOST = 0,
+    GAME_RESULT_WON = 1
+} GameResult;
+
+// One finished game as it is stored on disk. Fixed 32-byte layout so the log
+// can be walked straight out of a memory mapping.
+typedef struct {
+    uint32_t seed;
+    uint32_t timeMs;
+    uint32_t clicks;
+    uint16_t bbbv;
+    uint8_t level;
+    uint8_t result;
+    int64_t finishedAt;
+    uint8_t firstX;
+    uint8_t firstY;
+    uint16_t reserved;
+    uint32_t checksum;
+} GameRecord;
+
+// Aggregates per difficulty level, rebuilt from the log at startup and kept
+// current on every append.
+typedef struct {
+    uint32_t played;
+    uint32_t won;
+    uint32_t currentStreak;
+    uint32_t bestStreak;
+    int bestTimeCount;
+    uint32_t bestTimesMs[STATS_TOP_TIMES];
+} LevelStats;
+
+bool StatsOpen(const char* path);
+void StatsClose(void);
+bool StatsAppend(GameRecord record);
+const LevelStats* StatsGetLevel(int level);
+
+#endif